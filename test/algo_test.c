@@ -64,6 +64,28 @@ SL void fact_sum_mod_test() {
 }
 PE_REGISTER_TEST(&fact_sum_mod_test, "fact_sum_mod_test", BIG);
 
+SL void fact_mod_batch_test() {
+  vector<pair<uint64, uint64>> queries;
+  for (uint64 p : {10007, 1000003, 998244353}) {
+    for (uint64 n : {0, 1, 5, 10006, 10007, 54321, 999999, 3000000}) {
+      queries.emplace_back(n, p);
+    }
+  }
+  auto f = fact_mod_batch(queries);
+  auto s = fact_sum_mod_batch(queries);
+  for (int i = 0; i < static_cast<int>(queries.size()); ++i) {
+    const uint64 n = queries[i].first, p = queries[i].second;
+    uint64 now = 1, sum = 1;
+    for (uint64 j = 1; j <= n; ++j) {
+      now = mul_mod_ex(now, j, p);
+      sum = add_mod(sum, now, p);
+    }
+    assert(f[i] == static_cast<int64>(now));
+    assert(s[i] == static_cast<int64>(sum));
+  }
+}
+PE_REGISTER_TEST(&fact_mod_batch_test, "fact_mod_batch_test", SMALL);
+
 SL void power_sum_test() {
   assert(power_sum(10, 2, 1000000007) == 385);
   assert(power_sum(100, 100, 1000000007) == 568830579);
@@ -153,4 +175,98 @@ SL void gp_sum_mod_test() {
 }
 
 PE_REGISTER_TEST(&gp_sum_mod_test, "gp_sum_mod_test", SMALL);
+
+template <typename T>
+struct Min25PhiPolicy {
+  int degree() const { return 1; }
+  T coefficient(int k) const { return k == 0 ? T(-1) : T(1); }
+  T fpe(int64 p, int e) const {
+    T ret(p - 1);
+    for (int i = 1; i < e; ++i) ret *= T(p);
+    return ret;
+  }
+};
+
+struct Min25MuPolicy {
+  int degree() const { return 0; }
+  int64 coefficient(int /*k*/) const { return -1; }
+  int64 fpe(int64 /*p*/, int e) const { return e == 1 ? -1 : 0; }
+};
+
+// sigma2(n) = sum(d^2, d | n)
+template <typename T>
+struct Min25Sigma2Policy {
+  int degree() const { return 2; }
+  T coefficient(int k) const { return k == 1 ? T(0) : T(1); }
+  T fpe(int64 p, int e) const {
+    T ret(1), t(1);
+    for (int i = 0; i < e; ++i) ret += t *= T(p) * T(p);
+    return ret;
+  }
+};
+
+SL void min25_sieve_test() {
+  const int N = 1000000;
+  vector<int64> phi(N + 1), mu(N + 1), sigma2(N + 1, 0);
+  for (int i = 1; i <= N; ++i) {
+    phi[i] = i;
+    mu[i] = 1;
+  }
+  for (int i = 2; i <= N; ++i) {
+    if (phi[i] == i) {
+      for (int j = i; j <= N; j += i) {
+        phi[j] -= phi[j] / i;
+        mu[j] = (j / i) % i == 0 ? 0 : -mu[j];
+      }
+    }
+  }
+  for (int64 d = 1; d <= N; ++d) {
+    for (int64 j = d; j <= N; j += d) sigma2[j] += d * d;
+  }
+  for (int i = 1; i <= N; ++i) {
+    phi[i] += phi[i - 1];
+    mu[i] += mu[i - 1];
+    sigma2[i] += sigma2[i - 1];
+  }
+
+  using MT = NModNumber<CCMod64<1000000007>>;
+  for (int64 n : {1, 2, 3, 10, 97, 1000, 65536, 999999, 1000000}) {
+    auto s0 = min25_sieve<int64>(n, Min25PhiPolicy<int64>());
+    auto s1 = min25_sieve<int64, 4>(n, Min25MuPolicy());
+    auto s2 = min25_sieve<MT>(n, Min25Sigma2Policy<MT>());
+    // A low threshold lets the steps run in parallel at this size.
+    auto s3 = min25_sieve<MT, 4>(n, Min25Sigma2Policy<MT>(), 16);
+    for (auto& key : s0.fKeys()) {
+      assert(s0[key] == phi[key]);
+      assert(s1[key] == mu[key]);
+      assert(s2[key].value() == sigma2[key] % 1000000007);
+      assert(s3[key] == s2[key]);
+    }
+  }
+
+  const int64 n = 10000000000;
+  auto s = min25_sieve<MT, 4>(n, Min25PhiPolicy<MT>());
+  assert(s[n].value() == MuPhiSumModer(1000000007).get_sum_phi(n));
+  auto u = min25_sieve<MT, 4>(n, Min25PhiPolicy<MT>(), 1000);
+  for (auto& key : s.fKeys()) assert(u[key] == s[key]);
+#if PE_HAS_INT128
+  auto t = min25_sieve<int128, 4>(n, Min25PhiPolicy<int128>());
+  assert(t[n] % 1000000007 == s[n].value());
+#endif
+}
+
+PE_REGISTER_TEST(&min25_sieve_test, "min25_sieve_test", SMALL);
+
+SL void min25_sieve_performance_test() {
+  using MT = NModNumber<CCMod64<1000000007>>;
+  for (int64 n = 1000000000; n <= 10000000000000; n *= 10) {
+    TimeRecorder tr;
+    auto s = min25_sieve<MT, 8>(n, Min25PhiPolicy<MT>());
+    printf("n = %lld, sum(phi) = %lld, %s\n", static_cast<long long>(n),
+           static_cast<long long>(s[n].value()), tr.elapsed().format().c_str());
+  }
+}
+
+PE_REGISTER_TEST(&min25_sieve_performance_test, "min25_sieve_performance_test",
+                 BIG);
 }  // namespace algo_test
@@ -349,6 +349,19 @@ SL void test_utilities() {
   BigInteger v(1);
   for (int i = 1; i <= 100000; ++i) v *= i;
   // cout << tr.elapsed().format() << " " << v.bitCount() << endl;
+
+  // Squaring (schoolbook and ntt) against the product of two copies.
+  for (int size : {1, 2, 3, 10, 100, 5000}) {
+    BigInteger x = power(BigInteger(3), size * 20) - 1;
+    const BigInteger y = x;
+    assert(x * x == x * y);
+    x = -x;
+    assert(x * x == x * y * -1);
+  }
+  {
+    const BigInteger y = v;
+    assert(v * v == v * y);
+  }
 }
 
 SL void bi_test() {
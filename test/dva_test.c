@@ -39,9 +39,31 @@ SL void test_s1() {
   assert(orz[1000000] == 37550402023LL);
 }
 
+SL void test_lo_hi() {
+  for (int64 n : {1, 2, 3, 4, 8, 9, 10, 99, 100, 12345}) {
+    LoHiDVA<int64> lohi(n);
+    for (int64 v = 1; v <= lohi.m; ++v) lohi.lo[v] = v;
+    for (int i = 1; i < lohi.hiSize; ++i) lohi.hi[i] = n / i;
+    auto dva = lohi.toDVA();
+    for (auto item : dva.fItems()) assert(item.value == item.key);
+  }
+
+  // The small values aren't narrowed for a modular T.
+  using MT = NModNumber<CCMod64<1000000007>>;
+  auto s0 = prime_s0<MT>(100000000);
+  auto s1 = prime_s1<MT>(100000000);
+  auto t0 = prime_s0<int64>(100000000);
+  auto t1 = prime_s1<int64>(100000000);
+  for (auto& key : t0.fKeys()) {
+    assert(s0[key].value() == t0[key] % 1000000007);
+    assert(s1[key].value() == t1[key] % 1000000007);
+  }
+}
+
 SL void dva_test() {
   test_s0();
   test_s1();
+  test_lo_hi();
 }
 
 PE_REGISTER_TEST(&dva_test, "dva_test", SMALL);
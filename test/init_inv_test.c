@@ -14,6 +14,14 @@ SL void init_inv_test() {
     assert((int64)i * sresult[i] % mod == 1);
     assert(sresult[i] == lresult[i]);
   }
+  init_inv<mod>(lresult, n);
+  for (int i = 1; i < n; ++i) {
+    assert(sresult[i] == lresult[i]);
+  }
+  init_inv<7>(sresult, 20);
+  for (int i = 0; i < 20; ++i) {
+    assert(i % 7 == 0 ? sresult[i] == 0 : i * sresult[i] % 7 == 1);
+  }
 }
 
 PE_REGISTER_TEST(&init_inv_test, "init_inv_test", SMALL);
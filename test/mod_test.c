@@ -117,4 +117,127 @@ SL void frac_mod_test() {
 
 PE_REGISTER_TEST(&frac_mod_test, "frac_mod_test", SMALL);
 #endif
+#if PE_HAS_INT128
+template <typename N, typename T>
+SL void arithmetic_policy_test_impl(const N& zero, T mod) {
+  const int64 values[] = {0, 1, 2, 3, (int64)mod / 2, (int64)mod - 2,
+                          (int64)mod - 1};
+  for (int64 x : values)
+    for (int64 y : values) {
+      if (x >= mod || y >= mod) continue;
+      N a = zero + x, b = zero + y;
+      assert(a.value() == x && b.value() == y);
+      assert((a + b).value() == (int128)(x + y) % mod);
+      assert((a - b).value() == ((int128)x - y + mod) % mod);
+      assert((a * b).value() == (int128)x * y % mod);
+      assert((-a).value() == (mod - x) % mod);
+      assert((a == b) == (x == y));
+      assert((a < b) == (x < y));
+    }
+  N a = zero + (mod - 2);
+  ++a;
+  assert(a.value() == mod - 1);
+  ++a;
+  assert(a.value() == 0);
+  --a;
+  assert(a.value() == mod - 1);
+  N p = zero + 1, q = zero + 3;
+  int128 expected = 1;
+  for (int i = 0; i < 100; ++i) {
+    p *= q;
+    expected = expected * 3 % mod;
+  }
+  assert(p.value() == expected);
+}
+
+SL void arithmetic_policy_test() {
+  const int64 mod64 = 4611686018427387847LL;
+  const int32 mod32 = 2147483629;
+  {
+    using N = NModNumber<CCMod64<mod64>, APMont<int64>>;
+    arithmetic_policy_test_impl(N(0), mod64);
+  }
+  {
+    using N = NModNumber<CCMod<int32, mod32>, APMont<int32>>;
+    arithmetic_policy_test_impl(N(0), mod32);
+  }
+  {
+    using N = NModNumber<CCMod<uint64, 18446744073709551557ULL>,
+                         APMont<uint64>>;
+    N a(18446744073709551556ULL);
+    assert((a * a).value() == 1);
+  }
+  {
+    using N = NModNumber<CCMod64<mod64>, APBarrett<int64>>;
+    arithmetic_policy_test_impl(N(0), mod64);
+  }
+  {
+    using N = NModNumber<CCMod<int32, mod32>, APBarrett<int32>>;
+    arithmetic_policy_test_impl(N(0), mod32);
+  }
+  for (int64 mod : {(int64)3, (int64)1000000007, mod64}) {
+    TLMod<int64>::set(mod);
+    arithmetic_policy_test_impl(TLNMod64<APMont<int64>>(0), mod);
+    arithmetic_policy_test_impl(TLNMod64<APBarrett<int64>>(0), mod);
+  }
+  for (int64 mod : {(int64)5, (int64)998244353, mod64}) {
+    using N1 = NModNumberM<MemMod64, APMont<int64>>;
+    using N2 = NModNumberM<MemMod64, APBarrett<int64>>;
+    arithmetic_policy_test_impl(N1(0, MemMod64(mod)), mod);
+    arithmetic_policy_test_impl(N2(0, MemMod64(mod)), mod);
+  }
+}
+
+PE_REGISTER_TEST(&arithmetic_policy_test, "arithmetic_policy_test", SMALL);
+#endif
+#if PE_HAS_INT128
+SL void cc_mod_kernel_test() {
+  const int64 mod32 = 1000000007;
+  const int64 mod64 = 4611686018427387847LL;
+  const int64 mod64e = 4611686018427387904LL;
+  for (int64 x : {(int64)-5, (int64)0, (int64)3, (int64)123456789123LL})
+    for (int64 n : {0, 1, 2, 1000, 1000000007}) {
+      assert(power_mod<mod32>(x, n) == power_mod(x, n, mod32));
+      assert(power_mod<mod64>(x, n) == power_mod_ex(x, n, mod64));
+      assert(power_mod<mod64e>(x, n) == power_mod_ex(x, n, mod64e));
+      assert(power_mod<1>(x, n) == 0);
+    }
+  {
+    NModNumber<CCMod64<mod64>> a(mod64 - 1), b(mod64 - 2);
+    assert((a * b).value() == 2);
+    assert((a + b).value() == mod64 - 3);
+    assert((b - a).value() == mod64 - 1);
+  }
+  {
+    // Beyond int64, the default policy isn't APCC.
+    NModNumber<CCMod<uint64, 18446744073709551557ULL>> a(3), b(5);
+    assert((a * b).value() == 15);
+    assert((a + b).value() == 8);
+  }
+  {
+    const int N = 37;
+    vector<int64> a(N * N), b(N * N), c(N * N), d(N * N);
+    for (int i = 0; i < N * N; ++i) {
+      a[i] = mod64 - 1 - i;
+      b[i] = mod64 - 1 - 3 * i;
+    }
+    mat_mul_mat_mod<mod64>(&a[0], &b[0], &c[0], N);
+    for (int i = 0; i < N; ++i)
+      for (int j = 0; j < N; ++j) {
+        int128 s = 0;
+        for (int k = 0; k < N; ++k) {
+          s = (s + (int128)a[i * N + k] * b[k * N + j]) % mod64;
+        }
+        assert(c[i * N + j] == s);
+      }
+    for (auto& v : a) v %= mod32;
+    for (auto& v : b) v %= mod32;
+    mat_mul_mat_mod<mod32>(&a[0], &b[0], &c[0], N);
+    mat_mul_mat_mod(&a[0], &b[0], &d[0], mod32, N);
+    assert(c == d);
+  }
+}
+
+PE_REGISTER_TEST(&cc_mod_kernel_test, "cc_mod_kernel_test", SMALL);
+#endif
 }  // namespace mod_test
@@ -74,6 +74,366 @@ SL void get_factors_test() {
 
 PE_REGISTER_TEST(&get_factors_test, "get_factors_test", SMALL);
 
+SL void segmented_sieve_test() {
+  // pmask and plist initialized by the linear sieve are the expected results.
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  const int old_pcnt = pcnt;
+
+  pmask = plist = nullptr;
+  init_primes_segmented(1);
+  assert(pcnt == old_pcnt);
+  assert(equal(plist, plist + pcnt, old_plist));
+  assert(equal(pmask + 1, pmask + maxp + 1, old_pmask + 1));
+  delete[] pmask;
+  delete[] plist;
+
+  pmask = plist = nullptr;
+  init_primes_segmented(0);
+  assert(pmask == nullptr);
+  assert(pcnt == old_pcnt);
+  assert(equal(plist, plist + pcnt, old_plist));
+  for (int i = 0; i <= 100000; ++i) {
+    assert(is_prime(i) == (i > 1 && old_pmask[i] == i));
+  }
+  assert(factorize(999983LL * 999979) ==
+         (vector<pair<int64, int>>{{999979, 1}, {999983, 1}}));
+  delete[] plist;
+
+  for (int n : {0, 1, 2, 3, 5, 7, 29, 30, 31, 49, 100, 983040, 983041}) {
+    vector<int> expected;
+    for (int i = 2; i <= n; ++i) {
+      if (old_pmask[i] == i) expected.push_back(i);
+    }
+    vector<int> result(expected.size() + 1);
+    result.resize(pe_sieve_internal::sieve_wheel30(n, result.data()));
+    assert(result == expected);
+    vector<int> mask(n + 1);
+    result.assign(expected.size() + 1, 0);
+    result.resize(
+        pe_sieve_internal::sieve_pmask(n, mask.data(), result.data()));
+    assert(result == expected);
+    assert(equal(mask.begin() + 1, mask.end(), old_pmask + 1));
+  }
+
+  pmask = old_pmask;
+  plist = old_plist;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&segmented_sieve_test, "segmented_sieve_test", SMALL);
+
+SL void parallel_sieve_test() {
+  // Initialized by init_primes(1, 1).
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  int* old_phi = phi;
+  int* old_mu = mu;
+  const int old_pcnt = pcnt;
+
+  for (int cal_phi = 0; cal_phi < 2; ++cal_phi)
+    for (int cal_mu = 0; cal_mu < 2; ++cal_mu) {
+      pmask = plist = phi = mu = nullptr;
+      init_primes_parallel(cal_phi, cal_mu, 4);
+      assert(pcnt == old_pcnt);
+      assert(equal(plist, plist + pcnt, old_plist));
+      assert(equal(pmask + 1, pmask + maxp + 1, old_pmask + 1));
+      assert(!cal_phi || equal(phi, phi + maxp + 1, old_phi));
+      assert(!cal_mu || equal(mu, mu + maxp + 1, old_mu));
+      delete[] pmask;
+      delete[] plist;
+      delete[] phi;
+      delete[] mu;
+    }
+
+  pmask = old_pmask;
+  plist = old_plist;
+  phi = old_phi;
+  mu = old_mu;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&parallel_sieve_test, "parallel_sieve_test", SMALL);
+
+SL void compact_pmask_test() {
+  // Initialized by init_primes(1, 1).
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  int* old_phi = phi;
+  int* old_mu = mu;
+  const int old_pcnt = pcnt;
+
+  vector<int64> values;
+  for (int64 i = 1; i <= 100000; ++i) values.push_back(i);
+  for (int64 i = maxp - 100000; i <= maxp + 100000; ++i) values.push_back(i);
+  vector<vector<pair<int64, int>>> expected_factors;
+  vector<int64> expected_mu;
+  vector<int> expected_square_free;
+  for (auto v : values) {
+    expected_factors.push_back(factorize(v));
+    expected_mu.push_back(cal_mu(v));
+    expected_square_free.push_back(is_square_free(v));
+  }
+  const int64 n = 1000000000;
+  const int64 expected_mu_sum = MuSummer<int64>().get(n);
+  const int64 expected_phi_sum = MuPhiSumModer(1000000007).get_sum_phi(n);
+
+  pmask = plist = phi = mu = nullptr;
+  init_primes_compact(1, 1, 4);
+  assert(pmask == nullptr && mu == nullptr);
+  assert(pcnt == old_pcnt);
+  assert(equal(plist, plist + pcnt, old_plist));
+  assert(equal(phi, phi + maxp + 1, old_phi));
+  assert(equal(mu8, mu8 + maxp + 1, old_mu));
+  for (int i = 1; i <= maxp; ++i) {
+    assert(get_pmask(i) == old_pmask[i]);
+    assert(get_mu(i) == old_mu[i]);
+  }
+  // The summers read mu8.
+  assert(MuSummer<int64>().get(n) == expected_mu_sum);
+  assert(MuPhiSummer<int64>().get_sum_mu(n) == expected_mu_sum);
+  MuPhiSumModer moder(1000000007);
+  assert(moder.get_sum_phi(n) == expected_phi_sum);
+  assert(moder.get_sum_mu(n) == (expected_mu_sum % 1000000007 + 1000000007) %
+                                    1000000007);
+  for (int i = 0; i < sz(values); ++i) {
+    const int64 v = values[i];
+    assert(factorize(v) == expected_factors[i]);
+    assert(cal_mu(v) == expected_mu[i]);
+    assert(is_square_free(v) == expected_square_free[i]);
+    if (v <= maxp) {
+      assert(is_prime(v) == (v > 1 && old_pmask[v] == v));
+      assert(cal_mu_by_pmask(v) == old_mu[v]);
+    }
+  }
+  delete[] plist;
+  delete[] phi;
+  delete[] pmask16;
+  delete[] mu8;
+  pmask16 = nullptr;
+  mu8 = nullptr;
+
+  pmask = old_pmask;
+  plist = old_plist;
+  phi = old_phi;
+  mu = old_mu;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&compact_pmask_test, "compact_pmask_test", SMALL);
+
+SL void compact_pmask_tiny_test() {
+  // Initialized by init_primes(1, 1).
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  int* old_phi = phi;
+  int* old_mu = mu;
+  const int old_pcnt = pcnt;
+  const int64 old_maxp = maxp;
+
+  // No base prime if maxp < 4. INIT_MAXP asserts maxp >= 100000.
+  for (int64 tiny : {1, 2, 3, 4, 5, 10}) {
+    pmask = plist = phi = mu = nullptr;
+    maxp = tiny;
+    maxp2 = maxp * maxp;
+    init_primes_compact(1, 1);
+    int cnt = 0;
+    for (int i = 1; i <= maxp; ++i) {
+      const int prime = i > 1 && old_pmask[i] == i;
+      cnt += prime;
+      assert(is_prime(i) == prime);
+      assert(get_pmask(i) == old_pmask[i]);
+      assert(get_mu(i) == old_mu[i]);
+      assert(phi[i] == old_phi[i]);
+    }
+    assert(pcnt == cnt);
+    delete[] plist;
+    delete[] phi;
+    delete[] pmask16;
+    delete[] mu8;
+    pmask16 = nullptr;
+    mu8 = nullptr;
+  }
+
+  INIT_MAXP(old_maxp);
+  pmask = old_pmask;
+  plist = old_plist;
+  phi = old_phi;
+  mu = old_mu;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&compact_pmask_tiny_test, "compact_pmask_tiny_test", SMALL);
+
+SL void prime_tables_cache_test() {
+  // Initialized by init_primes(1, 1).
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  int* old_phi = phi;
+  int* old_mu = mu;
+  const int old_pcnt = pcnt;
+  const int64 old_maxp = maxp;
+
+  const int flags = get_prime_tables();
+  assert(flags == (PE_PRIME_TABLE_PLIST | PE_PRIME_TABLE_PMASK |
+                   PE_PRIME_TABLE_PHI | PE_PRIME_TABLE_MU));
+  const string path = prime_tables_path(
+      std::filesystem::temp_directory_path().string(), maxp, flags);
+  assert(save_prime_tables(path));
+
+  pmask = plist = phi = mu = nullptr;
+  pcnt = 0;
+  assert(!load_prime_tables(path, flags | PE_PRIME_TABLE_MU8));
+  assert(get_prime_tables() == 0);
+  assert(load_prime_tables(path, flags));
+  assert(get_prime_tables() == flags);
+  assert(pcnt == old_pcnt);
+  assert(equal(plist, plist + pcnt, old_plist));
+  assert(equal(pmask + 1, pmask + maxp + 1, old_pmask + 1));
+  assert(equal(phi, phi + maxp + 1, old_phi));
+  assert(equal(mu, mu + maxp + 1, old_mu));
+  assert(factorize(999983LL * 999979) ==
+         (vector<pair<int64, int>>{{999979, 1}, {999983, 1}}));
+
+  deinit_primes();
+  assert(get_prime_tables() == 0);
+  remove(path.c_str());
+
+  INIT_MAXP(old_maxp);
+  pmask = old_pmask;
+  plist = old_plist;
+  phi = old_phi;
+  mu = old_mu;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&prime_tables_cache_test, "prime_tables_cache_test", SMALL);
+
+SL void factorize_large_test() {
+  // Compared with trial division.
+  mt19937_64 rng(7);
+  for (int i = 0; i < 300; ++i) {
+    const int64 n = rng() % 1000000000000LL + 1;
+    vector<pair<int64, int>> expected;
+    int64 m = n;
+    for (int64 p = 2; p * p <= m; ++p) {
+      int c = 0;
+      while (m % p == 0) m /= p, ++c;
+      if (c) expected.emplace_back(p, c);
+    }
+    if (m > 1) expected.emplace_back(m, 1);
+    assert(factorize(n) == expected);
+    assert(is_prime(n) == (expected.size() == 1 && expected[0].second == 1));
+  }
+
+  // Products of the factors are n.
+  for (int i = 0; i < 300; ++i) {
+    const int64 n = rng() % 1000000000000000000LL + 1;
+    int64 m = 1;
+    for (auto& iter : factorize(n)) {
+      assert(is_prime_u64(iter.first));
+      for (int j = 0; j < iter.second; ++j) m *= iter.first;
+    }
+    assert(m == n);
+  }
+
+  const int64 p1 = 1000000007, p2 = 998244353, p3 = 2305843009213693951LL;
+  assert(is_prime(p3));
+  assert(!is_prime(p1 * p2));
+  assert(factorize(p1 * p2) == (vector<pair<int64, int>>{{p2, 1}, {p1, 1}}));
+  assert(factorize(p1 * p1 * 3) ==
+         (vector<pair<int64, int>>{{3, 1}, {p1, 2}}));
+  assert(cal_phi(p1 * p2) == (p1 - 1) * (p2 - 1));
+  assert(cal_mu(p1 * p2 * 5) == -1);
+  assert(cal_mu(p1 * p1 * 5) == 0);
+
+  assert(is_prime_u64(18446744073709551557ULL));
+  assert(!is_prime_u64(3825123056546413051ULL));
+  assert(factorize_u64(18446744073709551615ULL) ==
+         (vector<pair<uint64, int>>{{3, 1},
+                                    {5, 1},
+                                    {17, 1},
+                                    {257, 1},
+                                    {641, 1},
+                                    {65537, 1},
+                                    {6700417, 1}}));
+
+#if PE_HAS_INT128
+  const uint128 n = static_cast<uint128>(p3) * p1 * p2;
+  assert(!is_prime_u128(n));
+  assert(is_prime_u128((static_cast<uint128>(1) << 89) - 1));
+  assert(factorize_u128(n * 4) ==
+         (vector<pair<uint128, int>>{{2, 2}, {p2, 1}, {p1, 1}, {p3, 1}}));
+#endif
+}
+
+PE_REGISTER_TEST(&factorize_large_test, "factorize_large_test", SMALL);
+
+SL void small_maxp_factorize_test() {
+  // Initialized by init_primes(1, 1).
+  int* old_pmask = pmask;
+  int* old_plist = plist;
+  int* old_phi = phi;
+  int* old_mu = mu;
+  const int old_pcnt = pcnt;
+  const int64 old_maxp = maxp;
+
+  // plist runs out before sqrt(n) for n > maxp^2. INIT_MAXP asserts maxp >=
+  // 100000, but a smaller maxp is accepted if NDEBUG is defined.
+  pmask = plist = phi = mu = nullptr;
+  maxp = 100;
+  maxp2 = maxp * maxp;
+  init_primes(1, 1);
+  const int64 p1 = 1000000007, p2 = 998244353;
+  assert(!is_prime(101 * 103));
+  assert(is_prime(10007));
+  assert(!is_prime(p1 * p2));
+  assert(is_prime(p1));
+  assert(factorize(101 * 103) ==
+         (vector<pair<int64, int>>{{101, 1}, {103, 1}}));
+  assert(factorize(p1 * p2 * 4) ==
+         (vector<pair<int64, int>>{{2, 2}, {p2, 1}, {p1, 1}}));
+  assert(factorize(p1) == (vector<pair<int64, int>>{{p1, 1}}));
+  assert(cal_mu(p1 * p2 * 5) == -1);
+  assert(cal_mu(101 * 101 * 3) == 0);
+  assert(cal_mu(p1 * 7) == 1);
+  deinit_primes();
+
+  INIT_MAXP(old_maxp);
+  pmask = old_pmask;
+  plist = old_plist;
+  phi = old_phi;
+  mu = old_mu;
+  pcnt = old_pcnt;
+}
+
+PE_REGISTER_TEST(&small_maxp_factorize_test, "small_maxp_factorize_test",
+                 SMALL);
+
+SL void factorize_range_test() {
+  for (int64 low : {1LL, 999999000000LL}) {
+    const int64 size = 40000;
+    for (int thread_count : {1, 4}) {
+      auto result = factorize_range(low, size, thread_count);
+      assert(result.size() == size);
+      for (int64 n = low; n < low + size; ++n) {
+        assert(result.at(n) == factorize(n));
+      }
+    }
+    vector<int> visited(size);
+    factorize_range(
+        low, size,
+        [&](int64 n, const vector<pair<int64, int>>& f) {
+          assert(f == factorize(n));
+          ++visited[n - low];
+        },
+        4);
+    assert(count(visited.begin(), visited.end(), 1) == size);
+  }
+}
+
+PE_REGISTER_TEST(&factorize_range_test, "factorize_range_test", SMALL);
+
 SL void is_square_free_test() {
   const int64 n = maxp * 2;
   int64 ans1 = 0;
@@ -159,4 +159,94 @@ SL void ntt_performance_test() {
 
 PE_REGISTER_TEST(&ntt_performance_test, "ntt_performance_test", BIG);
 #endif
+
+SL void ntt32_engine_test() {
+  const ntt32::NttMod32* moders[3] = {&ntt32::nttMod1, &ntt32::nttMod2,
+                                      &ntt32::nttMod3};
+  const bool enabled = simd_enabled();
+  srand(123456789);
+  for (int simd = 0; simd < 2; ++simd) {
+    enable_simd(simd != 0);
+    for (auto* moder : moders) {
+      const uint64 mod = moder->mod;
+      // Compare with the definition.
+      for (int k = 0; k <= 7; ++k) {
+        const int n = 1 << k;
+        vector<uint64> a(n);
+        for (auto& v : a) v = (uint64)crand63();
+        vector<uint64> b = a;
+        ntt32::ntt(&b[0], n, *moder);
+        for (int i = 0; i < n; ++i) {
+          const uint64 w = power_mod<uint64>(moder->omg[k], i, mod);
+          uint64 s = 0, x = 1;
+          for (int j = 0; j < n; ++j) {
+            s = (s + a[j] % mod * x) % mod;
+            x = x * w % mod;
+          }
+          assert(b[i] == s);
+        }
+        ntt32::ntt(&b[0], n, *moder, true);
+        for (int i = 0; i < n; ++i) assert(b[i] == a[i] % mod);
+      }
+    }
+    for (int n : {1, 2, 50, 333, 1000, 4099}) {
+      for (int64 mod : {100019LL, 1000000007LL, 100000000003LL}) {
+        vector<uint64> x(n), y(n + 7);
+        for (auto& v : x) v = (uint64)crand63() % mod;
+        for (auto& v : y) v = (uint64)crand63() % mod;
+        auto expected = poly_mul_dc(x, y, mod);
+        assert(ntt32::poly_mul_ntt(x, y, mod) == expected);
+        if (ntt32::required_mods(n, n + 7, mod) == 2) {
+          assert(ntt32::poly_mul_ntt_small(x, y, mod) == expected);
+        }
+        assert(poly_mul(x, y, mod) == expected);
+
+        // Squaring: the operands are aliased.
+        const vector<uint64> z = x;
+        auto square = poly_mul_dc(x, z, mod);
+        assert(poly_mul_dc(x, x, mod) == square);
+        assert(ntt32::poly_mul_ntt(x, x, mod) == square);
+        if (ntt32::required_mods(n, n, mod) == 2) {
+          assert(ntt32::poly_mul_ntt_small(x, x, mod) == square);
+        }
+#if HAS_POLY_MUL_NTT64
+        assert(ntt64::poly_mul_ntt(x, x, mod) == square);
+#endif
+#if HAS_POLY_MUL_MIN25_NTT
+        assert(ntt_min25::poly_mul_ntt(x, x, mod) == square);
+#endif
+        assert(poly_sqr(x, mod) == square);
+      }
+    }
+  }
+  enable_simd(enabled);
+}
+PE_REGISTER_TEST(&ntt32_engine_test, "ntt32_engine_test", SMALL);
+
+// The AVX2 passes are selected at runtime, also if the build doesn't target
+// AVX2.
+SL void ntt32_avx2_dispatch_test() {
+#if PE_SIMD_HAS_AVX2 && defined(COMPILER_GNU)
+  if (!__builtin_cpu_supports("avx2")) return;
+  const bool enabled = simd_enabled();
+  const int64 mod = 1000000007;
+  vector<uint64> x(1000), y(1000);
+  for (auto& v : x) v = (uint64)crand63() % mod;
+  for (auto& v : y) v = (uint64)crand63() % mod;
+  auto& count = ntt32::ntt32_internal::avx2_pass_count();
+
+  enable_simd(false);
+  int64 before = count;
+  auto expected = ntt32::poly_mul_ntt(x, y, mod);
+  assert(count == before);
+
+  enable_simd(true);
+  before = count;
+  assert(ntt32::poly_mul_ntt(x, y, mod) == expected);
+  assert(count > before);
+  enable_simd(enabled);
+#endif
+}
+PE_REGISTER_TEST(&ntt32_avx2_dispatch_test, "ntt32_avx2_dispatch_test",
+                 SMALL);
 }  // namespace ntt_test
@@ -22,6 +22,7 @@
 #include "poly_algo_test.c"
 #include "fft_test.c"
 #include "prime_pi_sum_test.c"
+#include "simd_test.c"
 #include "square_root_test.c"
 #include "tree_test.c"
 
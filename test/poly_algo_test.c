@@ -53,6 +53,19 @@ SL void gf_test() {
     string expected = to_string("66666793333412666685000001"_bi % mod);
     assert(mine == expected);
   }
+
+  {
+    // A large A uses the online convolution.
+    srand(123456789);
+    vector<int64> A(500), B(300);
+    for (auto& v : A) v = crand63() % mod;
+    for (auto& v : B) v = crand63() % mod;
+    A[0] = 3;
+    auto x = gf_first(A, B, 2000, mod);
+    auto y = poly_mul(poly_inv(A, 2001, mod), B, mod);
+    y.resize(2001);
+    assert(x == y);
+  }
 }
 PE_REGISTER_TEST(&gf_test, "gf_test", SMALL);
 
@@ -80,6 +93,97 @@ SL void minimal_polynomial_test() {
 }
 PE_REGISTER_TEST(&minimal_polynomial_test, "minimal_polynomial_test", SMALL);
 
+SL void berlekamp_massey_test() {
+  // s[i] = sum_{j=1}^{d} c[j] * s[i - j] for i >= d, plus leading zeros which
+  // make the constant term of the minimal polynomial zero.
+  auto gen = [](int d, int zeros, int len) {
+    vector<int64> c(d + 1), s(len);
+    for (auto& v : c) v = crand63() % mod;
+    c[d] = crand63() % (mod - 1) + 1;
+    for (int i = 0; i < d + zeros; ++i) s[i] = crand63() % mod;
+    for (int i = 0; i < zeros; ++i) s[i] = 0;
+    for (int i = d + zeros; i < len; ++i) {
+      for (int j = 1; j <= d; ++j) {
+        s[i] = add_mod(s[i], c[j] * s[i - j] % mod, mod);
+      }
+    }
+    // the monic minimal polynomial
+    vector<int64> p(zeros + d + 1);
+    p[zeros + d] = 1;
+    for (int j = 1; j <= d; ++j) p[zeros + d - j] = c[j] ? mod - c[j] : 0;
+    return make_tuple(s, NModPoly(p, mod, 0));
+  };
+
+  for (int d : {1, 5, 40, 300, 4000}) {
+    for (int zeros : {0, 3}) {
+      vector<int64> s;
+      NModPoly p;
+      tie(s, p) = gen(d, zeros, 2 * (d + zeros) + 7);
+      NModPoly ps(s, mod, 0);
+
+      auto c = berlekamp_massey(s, mod);
+      assert(sz(c) == p.size());
+      assert(NModPoly(vector<int64>(c.rbegin(), c.rend()), mod, 0) == p);
+      assert(find_linear_recurrence(ps) == p);
+      auto even = ps.lowerTerms(2 * (d + zeros), 0);
+      assert(find_minimal_poly(even) == p);
+      assert(min_poly_internal::find_minimal_poly_hgcd(even) == p);
+      assert(nth_element(s, mod, s.size() + 10) ==
+             nth_element(even, s.size() + 10, p));
+
+      // Not determined by 2 * (d + zeros) terms.
+      assert(find_linear_recurrence(even).data.empty());
+      assert(find_linear_recurrence(ps.lowerTerms(even.size() + 1, 0)) == p);
+    }
+  }
+
+  using T = NMod<int64, mod>;
+  auto fib = berlekamp_massey(vector<T>{0, 1, 1, 2, 3, 5, 8});
+  assert(fib.size() == 3);
+  assert(fib[0].value() == 1);
+  assert(fib[1].value() == mod - 1 && fib[2].value() == mod - 1);
+}
+PE_REGISTER_TEST(&berlekamp_massey_test, "berlekamp_massey_test", SMALL);
+
+SL void bostan_mori_test() {
+  srand(123456789);
+  for (int64 mod : {1000000007LL, 10000000000037LL}) {
+    for (int d : {0, 1, 5, 200}) {
+      vector<int64> Q(d + 1), P(d + 3);
+      for (auto& v : Q) v = crand63() % mod;
+      for (auto& v : P) v = crand63() % mod;
+      Q[0] = 1 + crand63() % (mod - 1);
+      const int64 iq = inv_of(Q[0], mod);
+      vector<int64> ns, f;
+      for (int i = 0; i <= 3 * d + 10; ++i) {
+        int64 t = i < sz(P) ? P[i] : 0;
+        for (int j = 1; j <= min(i, d); ++j) {
+          t = sub_mod(t, mul_mod_ex(Q[j], f[i - j], mod), mod);
+        }
+        f.push_back(mul_mod_ex(t, iq, mod));
+        ns.push_back(i);
+      }
+      ns.push_back(1000000000000000000LL);
+      ns.push_back(123456789);
+      ns.push_back(123456788);
+      auto batch = bostan_mori(P, Q, ns, mod);
+      for (int i = 0; i < sz(ns); ++i) {
+        if (i < sz(f)) assert(batch[i] == f[i]);
+        if (i % 50 == 0 || i >= sz(f)) {
+          assert(batch[i] == bostan_mori(P, Q, ns[i], mod));
+        }
+      }
+      if (mod < PE_SOI63) {
+        assert(gf_at(Q, P, ns, mod) == batch);
+        for (int i = 0; d <= 5 && i < sz(ns); ++i) {
+          assert(batch[i] == gf_at_matrix(Q, P, ns[i], mod));
+        }
+      }
+    }
+  }
+}
+PE_REGISTER_TEST(&bostan_mori_test, "bostan_mori_test", SMALL);
+
 SL void poly_multipoint_evaluation_test() {
   srand(123456789);
   vector<int64> data;
@@ -119,6 +223,43 @@ SL void poly_multipoint_evaluation_test() {
 PE_REGISTER_TEST(&poly_multipoint_evaluation_test,
                  "poly_multipoint_evaluation_test", SMALL);
 
+SL void poly_interpolation_test() {
+  for (int64 mod : {1000000007LL, 10000000000037LL}) {
+    for (int n : {1, 2, 3, 17, 100, 1000, 3001}) {
+      if (mod > 1000000007 && n > 1000) continue;
+      set<uint64> used;
+      vector<uint64> v, x(n), y(n);
+      while (sz(v) < n) {
+        uint64 t = crand63() % mod;
+        if (used.insert(t).second) v.push_back(t);
+      }
+      for (auto& t : x) t = crand63() % mod;
+      for (int i = 0; i < n; ++i) {
+        for (int j = n - 1; j >= 0; --j) {
+          y[i] = add_mod(mul_mod_ex(y[i], v[i], mod), x[j], mod);
+        }
+      }
+      assert(poly_multipoint_evaluate_normal(x, v, mod) == y);
+      assert(poly_multipoint_evaluate_bls(x, v, mod) == y);
+      assert(poly_interpolate(v, y, mod) == x);
+
+      for (int cache : {0, 1}) {
+        PolySubproductTree<uint64> tree(&v[0], n, mod, cache);
+        vector<uint64> z(n), w(n);
+        // deg x2 >= n
+        auto x2 = poly_mul(x, x, mod);
+        tree.evaluate(&x2[0], 2 * n - 1, &z[0]);
+        for (int i = 0; i < n; ++i) assert(z[i] == mul_mod_ex(y[i], y[i], mod));
+        tree.evaluate(&x[0], n, &z[0]);
+        assert(z == y);
+        tree.interpolate(&y[0], &w[0]);
+        assert(w == x);
+      }
+    }
+  }
+}
+PE_REGISTER_TEST(&poly_interpolation_test, "poly_interpolation_test", SMALL);
+
 SL void poly_batch_mul_test() {
   const int mod = 10007;
   vector<int64> data{1, 1, 2, 1, 3, 1};
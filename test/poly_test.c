@@ -47,4 +47,236 @@ SL void poly_mod_test() {
   assert(m1 == m2);
 }
 PE_REGISTER_TEST(&poly_mod_test, "poly_mod_test", SMALL);
+
+SL void ntt_poly_test() {
+  const int64 mod = 1000000007;
+  srand(123456789);
+  vector<int64> a(300), b(500), c(200), d(600);
+  for (auto* v : {&a, &b, &c, &d}) {
+    for (auto& x : *v) x = crand63() % mod;
+  }
+  // a * b + c * d with one inverse transform.
+  const int mods = ntt32::required_mods(600, 600, mod);
+  const int size = 1 << pe_lg(2 * 799 - 1);
+  auto ah = ntt32::ntt_poly_transform(a, size, mods);
+  auto bh = ntt32::ntt_poly_transform(b, size, mods);
+  auto ch = ntt32::ntt_poly_transform(c, size, mods);
+  auto dh = ntt32::ntt_poly_transform(d, size, mods);
+  ntt32::NttPoly acc(size, mods);
+  ntt32::ntt_poly_mul_add(acc, ah, bh);
+  ntt32::ntt_poly_mul_add(acc, ch, dh);
+  auto result = ntt32::ntt_poly_inverse<int64>(acc, 799, mod);
+  auto expected = poly_add(poly_mul_dc(a, b, mod), poly_mul_dc(c, d, mod), mod);
+  assert(result == expected);
+  ntt32::ntt_poly_mul(ah, bh);
+  assert(ntt32::ntt_poly_inverse<int64>(ah, 799, mod) ==
+         poly_mul_dc(a, b, mod));
+
+  // Fixed divisor.
+  for (int m : {1, 2, 30, 300}) {
+    vector<int64> y(m);
+    for (auto& x : y) x = crand63() % mod;
+    y[m - 1] = 1 + crand63() % (mod - 1);
+    const PolyModer<int64> moder(&y[0], m, mod);
+    for (int n : {1, m, m + 1, 2 * m - 1, 2 * m, 3 * m}) {
+      vector<int64> x(n);
+      for (auto& v : x) v = crand63() % mod;
+      vector<int64> q1(max(n - m + 1, 1)), r1(m), q2(q1.size()), r2(m);
+      moder.div_and_mod(&x[0], n, &q1[0], &r1[0]);
+      poly_div_and_mod_normal(&x[0], n, &y[0], m, &q2[0], &r2[0], mod);
+      assert(q1 == q2);
+      assert(vector<int64>(r1.begin(), r1.end() - 1) ==
+             vector<int64>(r2.begin(), r2.end() - 1));
+    }
+  }
+
+  // x^n % f
+  vector<int64> f(200);
+  for (auto& v : f) v = crand63() % mod;
+  f.back() = 1;
+  const NModPoly fp(f, mod);
+  NModPoly expected_pow({1}, mod);
+  const NModPoly x({0, 1}, mod);
+  for (int e = 1; e <= 300; ++e) {
+    expected_pow = poly_mod_normal(expected_pow * x, fp);
+  }
+  assert((300 % fp) == expected_pow);
+
+  // Newton inverse.
+  vector<int64> g(1000);
+  for (auto& v : g) v = crand63() % mod;
+  g[0] = 1;
+  auto ig = poly_inv(g, 1000, mod);
+  auto one = poly_mul_dc(g, ig, mod);
+  assert(one[0] == 1);
+  for (int i = 1; i < 1000; ++i) assert(one[i] == 0);
+}
+PE_REGISTER_TEST(&ntt_poly_test, "ntt_poly_test", SMALL);
+
+SL void poly_product_part_test() {
+  srand(123456789);
+  // 10000000000037 is a prime, its products don't fit the ntt32 moduli.
+  for (int64 mod : {1000000007LL, 10000000000037LL}) {
+    for (int n : {1, 7, 60, 1000}) {
+      for (int m : {1, 5, 60, 700}) {
+        if (m > n) continue;
+        vector<int64> x(n), y(m);
+        for (auto& v : x) v = crand63() % mod;
+        for (auto& v : y) v = crand63() % mod;
+        const vector<int64> z = x;
+        for (auto [a, b] : {make_pair(&x, &y), make_pair(&x, &x)}) {
+          const auto full = poly_mul_dc(*a, a == b ? z : *b, mod);
+          const int total = (int)full.size();
+          for (int k : {1, m, n, total - 1, total}) {
+            auto low = poly_mul_low(*a, *b, k, mod);
+            assert(equal(low.begin(), low.end(), full.begin()));
+            auto high = poly_mul_high(*a, *b, total - k, mod);
+            assert(equal(high.begin(), high.end(), full.end() - k));
+          }
+          auto mid = poly_middle_product(*a, *b, mod);
+          const int bm = (int)b->size();
+          assert(equal(mid.begin(), mid.end(), full.begin() + bm - 1));
+        }
+      }
+    }
+
+    // Newton iterations against the O(n^2) recurrences.
+    const int n = 300;
+    vector<int64> f(n), inv(n + 1);
+    init_inv(&inv[0], n + 1, mod);
+    for (auto& v : f) v = crand63() % mod;
+    f[0] = 0;
+    // e' = f' e
+    vector<int64> e(n);
+    e[0] = 1;
+    for (int k = 1; k < n; ++k) {
+      int64 s = 0;
+      for (int j = 1; j <= k; ++j) {
+        s = add_mod(s, mul_mod_ex(j, mul_mod_ex(f[j], e[k - j], mod), mod),
+                    mod);
+      }
+      e[k] = mul_mod_ex(s, inv[k], mod);
+    }
+    assert(poly_exp_normal(f, n, mod) == e);
+    f[0] = 0;
+    assert(poly_log_normal(e, n, mod) == f);
+    auto ie = poly_inv(e, n, mod);
+    auto one = poly_mul_dc(e, ie, mod);
+    assert(one[0] == 1);
+    for (int i = 1; i < n; ++i) assert(one[i] == 0);
+  }
+}
+PE_REGISTER_TEST(&poly_product_part_test, "poly_product_part_test", SMALL);
+
+SL void poly_online_convolution_test() {
+  srand(123456789);
+  for (int64 mod : {1000000007LL, 10000000000037LL}) {
+    for (int n : {1, 2, 33, 100, 3000}) {
+      vector<int64> a(n / 2 + 1);
+      for (auto& v : a) v = crand63() % mod;
+      // f[i] = c + i
+      auto f = poly_online_convolution(
+          a, n, [&](int i, int64 c) { return add_mod(c, i, mod); }, mod);
+      vector<int64> g(n);
+      for (int i = 0; i < n; ++i) {
+        int64 c = i;
+        for (int j = 1; j <= i && j < sz(a); ++j) {
+          c = add_mod(c, mul_mod_ex(a[j], g[i - j], mod), mod);
+        }
+        g[i] = c;
+      }
+      assert(f == g);
+    }
+  }
+
+  // Partition numbers: n p(n) = sum sigma(k) p(n - k).
+  const int64 mod = 1000000007;
+  const int n = 2000;
+  vector<int64> sigma(n), inv(n);
+  for (int i = 1; i < n; ++i) {
+    for (int j = i; j < n; j += i) sigma[j] += i;
+  }
+  init_inv(&inv[0], n, mod);
+  auto p = poly_online_convolution(
+      sigma, n,
+      [&](int i, int64 c) { return i == 0 ? 1 : mul_mod_ex(c, inv[i], mod); },
+      mod);
+  vector<int64> q(n);
+  q[0] = 1;
+  for (int k = 1; k < n; ++k) {
+    for (int i = k; i < n; ++i) q[i] = add_mod(q[i], q[i - k], mod);
+  }
+  assert(p == q);
+}
+PE_REGISTER_TEST(&poly_online_convolution_test, "poly_online_convolution_test",
+                 SMALL);
+
+SL void poly_gcd_test() {
+  const int64 mod = 998244353;
+  auto rand_poly = [=](int n) {
+    vector<int64> v(n + 1);
+    for (auto& x : v) x = crand63() % mod;
+    v[n] = crand63() % (mod - 1) + 1;
+    return NModPoly(v, mod);
+  };
+  // res(a, b) by the plain Euclidean algorithm.
+  auto naive_resultant = [=](NModPoly a, NModPoly b) -> int64 {
+    int64 ret = 1;
+    while (b.deg() > 0 || b[0] != 0) {
+      if (b.deg() == 0) {
+        return ret * power_mod(b[0], a.deg(), mod) % mod;
+      }
+      NModPoly r = a % b;
+      if (r.isZero()) return 0;
+      ret = ret * power_mod(b.data.back(), a.deg() - r.deg(), mod) % mod;
+      if (a.deg() & b.deg() & 1) ret = (mod - ret) % mod;
+      a = std::move(b);
+      b = std::move(r);
+    }
+    return 0;
+  };
+
+  for (int n : {0, 1, 5, 63, 64, 200, 1000}) {
+    for (int m : {0, 3, n / 2, n}) {
+      NModPoly g = rand_poly(n / 3);
+      g = inv_of(g.data.back(), mod) * g;
+      NModPoly a = g * rand_poly(n), b = g * rand_poly(m);
+      assert(poly_gcd(a, b) == g);
+      assert(poly_gcd(b, a) == g);
+      assert(poly_gcd(a, NModPoly{{0}, mod}) ==
+             inv_of(a.data.back(), mod) * a);
+
+      NModPoly d, u, v;
+      tie(d, u, v) = poly_exgcd(a, b);
+      assert(d == g);
+      assert(u * a + v * b == g);
+      assert(u.deg() < max(b.deg() - g.deg(), 1));
+      assert(v.deg() < max(a.deg() - g.deg(), 1));
+
+      NModPoly x = rand_poly(n), y = rand_poly(m), z = rand_poly(n / 2 + 1);
+      const int64 r = poly_resultant(x, y);
+      if (n <= 200) assert(r == naive_resultant(x, y));
+      assert(poly_resultant(y, x) ==
+             ((n & m & 1) ? (mod - r) % mod : r));
+      assert(poly_resultant(x * z, y) ==
+             poly_resultant(x, y) * poly_resultant(z, y) % mod);
+      if (g.deg() > 0) assert(poly_resultant(a, b) == 0);
+    }
+  }
+
+  for (int n : {10, 100, 1000}) {
+    for (int k : {1, n / 3, n / 2, n - 1}) {
+      NModPoly p = rand_poly(k - 1), q = rand_poly(n - k);
+      q[0] = 1;
+      auto f = poly_mul(p, poly_inv(q, n)).lowerTerms(n);
+      NModPoly pp, qq;
+      tie(pp, qq) = poly_rational_reconstruction(f, NModPoly{{1}, mod} << n, k);
+      assert(pp.deg() < k && qq.deg() <= n - k);
+      assert(pp * q == p * qq);
+      tie(pp, qq) = poly_pade(f, k - 1, n - k);
+      assert(pp * q == p * qq);
+    }
+  }
+}
+PE_REGISTER_TEST(&poly_gcd_test, "poly_gcd_test", SMALL);
 }  // namespace poly_test
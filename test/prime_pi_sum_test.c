@@ -46,6 +46,101 @@ SL void prime_pi_sum_test() {
 
 PE_REGISTER_TEST(&prime_pi_sum_test, "prime_pi_sum_test", BIG);
 
+SL void prime_pi_sum_parallel_test() {
+  for (int64 n : {1LL, 2LL, 100LL, 99999LL, 1000000LL, 100000000000LL}) {
+    auto s0 = prime_s0<int64>(n);
+    auto s1 = prime_s1<int64>(n);
+    auto p0 = prime_s0_parallel<int64, 4>(n);
+    auto p1 = prime_s1_parallel<int64, 4>(n);
+    assert(s0.values == p0.values);
+    assert(s1.values == p1.values);
+  }
+}
+
+PE_REGISTER_TEST(&prime_pi_sum_parallel_test, "prime_pi_sum_parallel_test",
+                 SMALL);
+
+template <int TN>
+SL void prime_pi_parallel_scaling(int64 n, int e) {
+  TimeRecorder tr;
+  auto s = prime_s0_parallel<int64, TN>(n);
+  assert(s[n] == pmpi[e]);
+  printf("n = 1e%d, threads = %d, %s\n", e, TN,
+         tr.elapsed().format().c_str());
+}
+
+SL void prime_pi_parallel_scaling_test() {
+  for (int e = 13; e <= 15; e += 2) {
+    const int64 n = power(10LL, e);
+    prime_pi_parallel_scaling<1>(n, e);
+    prime_pi_parallel_scaling<2>(n, e);
+    prime_pi_parallel_scaling<4>(n, e);
+    prime_pi_parallel_scaling<8>(n, e);
+    prime_pi_parallel_scaling<16>(n, e);
+    prime_pi_parallel_scaling<32>(n, e);
+    prime_pi_parallel_scaling<64>(n, e);
+  }
+}
+
+PE_REGISTER_TEST(&prime_pi_parallel_scaling_test,
+                 "prime_pi_parallel_scaling_test", BIG);
+
+SL void remove_resumable_files(const string& path, int ranks) {
+  for (int r = 0; r < ranks; ++r) {
+    const string prefix = path + "." + to_string(r);
+    remove((prefix + ".ckpt").c_str());
+    for (int b = 0;; ++b) {
+      if (remove((prefix + "." + to_string(b) + ".rows").c_str())) break;
+    }
+  }
+}
+
+// The values of prime_s1 before the sieve.
+SL DVA<int64> prime_s1_init(int64 n) {
+  DVA<int64> dva(n);
+  for (auto key : dva.fKeys()) {
+    dva[key] = key & 1 ? (key + 1) / 2 * key - 1 : key / 2 * (key + 1) - 1;
+  }
+  return dva;
+}
+
+SL void prime_pi_sum_resumable_test() {
+  const string path = "prime_pi_sum_resumable_test";
+  auto step = [](int64& value, int64 source, int64 base, int64 p) {
+    value -= (source - base) * p;
+  };
+  for (int64 n : {1LL, 2LL, 100LL, 12345LL, 10000000000LL}) {
+    auto s0 = prime_s0<int64>(n);
+    auto s1 = prime_s1<int64>(n);
+    remove_resumable_files(path, 1);
+    assert(prime_s0_resumable<int64>(n, path).values == s0.values);
+    remove_resumable_files(path, 1);
+    assert(prime_s1_resumable<int64>(n, path).values == s1.values);
+
+    for (int ranks : {1, 2, 3, 7}) {
+      remove_resumable_files(path, ranks);
+      // The ranks run one by one from the highest one, which reads no rows.
+      // Every rank stops after a few primes and resumes in another object.
+      for (int r = ranks - 1; r >= 0; --r) {
+        for (int64 until : {30LL, -1LL}) {
+          auto dva = prime_s1_init(n);
+          ResumableLucy<int64> lucy(dva, path, PE_LUCY_STEP_S1, r, ranks);
+          assert(lucy.loaded() == (until < 0));
+          lucy.set_batch_work(1000);
+          lucy.run(step, until);
+        }
+      }
+      auto merged =
+          ResumableLucy<int64>::merge(n, path, PE_LUCY_STEP_S1, ranks);
+      assert(merged.values == s1.values);
+    }
+    remove_resumable_files(path, 7);
+  }
+}
+
+PE_REGISTER_TEST(&prime_pi_sum_resumable_test, "prime_pi_sum_resumable_test",
+                 SMALL);
+
 SL void prime_pi_sum_pmod_test() {
   const int64 N = 100000;
   for (int mod = 1; mod <= 30; ++mod) {
@@ -85,4 +180,84 @@ SL void prime_pi_sum_pmod_test() {
   }
 }
 PE_REGISTER_TEST(&prime_pi_sum_pmod_test, "prime_pi_sum_pmod_test", SMALL);
+
+SL void prime_sk_fused_test() {
+  for (int64 n : {1LL, 2LL, 10LL, 99LL, 100LL, 12345LL, 1000000LL}) {
+    auto v = prime_sk_fused<int64, 3>(n);
+    auto v0 = prime_s0<int64>(n);
+    auto v1 = prime_s1<int64>(n);
+    for (auto key : v0.fKeys()) {
+      int64 s2 = 0;
+      for (int i = 0; i < pcnt && plist[i] <= key; ++i) {
+        s2 += (int64)plist[i] * plist[i];
+      }
+      assert(v[0][key] == v0[key]);
+      assert(v[1][key] == v1[key]);
+      assert(v[2][key] == s2);
+    }
+  }
+
+  const int64 N = 10000000000;
+  const int64 M = 1000000007;
+  using NT = NModNumber<CCMod64<M>>;
+  auto v0 = prime_s0<int64>(N);
+  auto v1 = prime_sk_ex<M>(N, 1);
+  auto u = prime_sk_fused<NT, 3>(N);
+  for (auto key : v0.fKeys()) {
+    assert(u[0][key].value() == v0[key] % M);
+    assert(u[1][key].value() == v1[key]);
+  }
+  assert(u[2][N].value() == prime_sk_ex<M>(N, 2)[N]);
+}
+
+PE_REGISTER_TEST(&prime_sk_fused_test, "prime_sk_fused_test", SMALL);
+
+#if PE_HAS_INT128
+SL void prime_sk_fused_int128_test() {
+  for (int64 n : {1LL, 2LL, 10LL, 99LL, 100LL, 12345LL, 1000000LL}) {
+    auto v = prime_sk_fused<int128, 4>(n);
+    auto v0 = prime_s0<int64>(n);
+    for (auto key : v0.fKeys()) {
+      int128 s3 = 0;
+      for (int i = 0; i < pcnt && plist[i] <= key; ++i) {
+        s3 += (int128)plist[i] * plist[i] * plist[i];
+      }
+      assert(v[0][key] == v0[key]);
+      assert(v[3][key] == s3);
+    }
+  }
+
+  const int64 N = 10000000000;
+  auto v0 = prime_s0<int64>(N);
+  auto v1 = prime_s1<int128>(N);
+  auto v = prime_sk_fused<int128, 2, 4>(N);
+  // A low threshold lets the steps run in parallel at this size.
+  auto w = prime_sk_fused<int128, 2, 4>(N, 1000);
+  for (auto key : v0.fKeys()) {
+    assert(v[0][key] == v0[key]);
+    assert(v[1][key] == v1[key]);
+    assert(w[0][key] == v0[key]);
+    assert(w[1][key] == v1[key]);
+  }
+}
+
+PE_REGISTER_TEST(&prime_sk_fused_int128_test, "prime_sk_fused_int128_test",
+                 SMALL);
+#endif
+
+SL void prime_pi_lmo_test() {
+  for (int64 n = 1; n <= 30000000; n = n * 5 / 4 + 1) {
+    assert(prime_pi_lmo(n) == prime_pi<int64>(n)[n]);
+  }
+  for (int e = 1; e <= 12; ++e) {
+    assert(prime_pi_lmo(power(10LL, e)) == pmpi[e]);
+  }
+
+  CachedPi cachedPi(100000);
+  assert(cachedPi(99991) == 9592);
+  assert(cachedPi(10000000000) == pmpi[10]);
+  assert(cachedPi(98765432109) == 4069301009);
+}
+
+PE_REGISTER_TEST(&prime_pi_lmo_test, "prime_pi_lmo_test", SMALL);
 }  // namespace prime_pi_sum_test
@@ -0,0 +1,46 @@
+#include "pe_test.h"
+
+namespace simd_test {
+SL void simd_kernel_test() {
+  const bool enabled = simd_enabled();
+  const int64 mods[] = {3, 998244353, 2281701377LL, 4294967295LL, 1000000006,
+                        100000000003LL};
+  for (bool simd : {false, true})
+    for (int64 mod : mods)
+      for (int n : {5, 16, 37, 1000}) {
+        enable_simd(simd);
+        vector<uint64> a(n), b(n), s(n), d(n), p(n), q(n);
+        for (int i = 0; i < n; ++i) {
+          a[i] = ((uint64)rand() * 1000003 + rand()) % mod;
+          b[i] = ((uint64)rand() * 1000033 + rand()) % mod;
+        }
+        a[0] = mod - 1;
+        b[0] = mod - 1;
+        const uint64 c = b[n / 2];
+        vec_add_mod(&a[0], &b[0], &s[0], n, mod);
+        vec_sub_mod(&a[0], &b[0], &d[0], n, mod);
+        vec_mul_mod(&a[0], &b[0], &p[0], n, mod);
+        vec_scale_mod(&a[0], c, &q[0], n, mod);
+        for (int i = 0; i < n; ++i) {
+          assert(s[i] == add_mod(a[i], b[i], mod));
+          assert(d[i] == sub_mod(a[i], b[i], mod));
+          assert(p[i] == mul_mod_ex(a[i], b[i], mod));
+          assert(q[i] == mul_mod_ex(a[i], c, mod));
+        }
+        for (int64 step : {1, -1, 7}) {
+          vector<int64> x(n + 1);
+          vec_seq_prod_mod(&x[0], mod - 5, step, n, mod);
+          int64 t = 1 % mod;
+          int64 v = mod - 5;
+          for (int i = 0; i <= n; ++i) {
+            assert(x[i] == t);
+            t = mul_mod_ex(t, regulate_mod(v, mod), mod);
+            v += step;
+          }
+        }
+      }
+  enable_simd(enabled);
+}
+
+PE_REGISTER_TEST(&simd_kernel_test, "simd_kernel_test", SMALL);
+}  // namespace simd_test